@@ -4,10 +4,90 @@
 #include <cmath>
 #include <fstream>
 #include <chrono>
+#include <thread>
+#include <algorithm>
+#include <string>
+#include <functional>
+#include <mutex>
+#include <condition_variable>
 
 using namespace std;
 using matrix2d = vector<vector<int>>;
 
+// Cantidad de multiplicaciones de un lote que se procesan a la vez en los kernels
+constexpr int batchLaneCount = 16;
+
+// Dimensión máxima con kernel especializado para multiplicación por lotes
+constexpr int maxBatchedDimension = 32;
+
+/*
+ * Nombre: matrixBatch
+ *
+ * Descripción: Lote de matrices cuadradas de la misma dimensión guardadas
+ * de forma intercalada (SoA) en bloques de batchLaneCount matrices. Dentro
+ * de un bloque, el elemento (fila, columna) de las batchLaneCount matrices
+ * queda contiguo, así la matriz número k tiene ese elemento en
+ * data[((k / batchLaneCount) * dimension * dimension + fila * dimension + columna) * batchLaneCount + k % batchLaneCount].
+ * El último bloque se rellena con matrices de 0.
+ */
+struct matrixBatch {
+	int dimension;
+	int batchSize;
+	int blockCount;
+	vector<int> data;
+};
+
+/*
+ * Nombre: csrMatrix
+ *
+ * Descripción: Matriz dispersa guardada por filas (Compressed Sparse Row).
+ * Los elementos distintos de 0 de la fila i se encuentran entre las
+ * posiciones rowPointers[i] y rowPointers[i + 1] de columnIndices y values,
+ * ordenados por columna.
+ */
+struct csrMatrix {
+	int rowCount;
+	int columnCount;
+	vector<int> rowPointers;
+	vector<int> columnIndices;
+	vector<int> values;
+};
+
+/*
+ * Nombre: cscMatrix
+ *
+ * Descripción: Matriz dispersa guardada por columnas (Compressed Sparse
+ * Column). Los elementos distintos de 0 de la columna j se encuentran entre
+ * las posiciones columnPointers[j] y columnPointers[j + 1] de rowIndices y
+ * values, ordenados por fila.
+ */
+struct cscMatrix {
+	int rowCount;
+	int columnCount;
+	vector<int> columnPointers;
+	vector<int> rowIndices;
+	vector<int> values;
+};
+
+/*
+ * Nombre: batchIndex
+ *
+ * Descripción: Calcula la posición de un elemento de una matriz de un lote
+ *
+ * Parámetros:
+ * - matrixBatch& batch, lote de matrices
+ * - int index, posición de la matriz dentro del lote
+ * - int row, fila del elemento
+ * - int column, columna del elemento
+ *
+ * Returns: int, posición del elemento en batch.data
+ */
+int batchIndex(matrixBatch& batch, int index, int row, int column) {
+	int N = batch.dimension;
+	int block = index / batchLaneCount;
+	return ((block * N + row) * N + column) * batchLaneCount + index % batchLaneCount;
+}
+
 // Funciones auxiliares
 
 /*
@@ -73,6 +153,113 @@ matrix2d subtract(matrix2d A, matrix2d B) {
 	return C;
 }
 
+/*
+ * Nombre: inPlaceTranspose
+ *
+ * Descripción: transpone una matriz cuadrada intercambiando sus elementos
+ * en el lugar, recorriendo la mitad inferior por columnas. Es la
+ * transposición que ocupaba optimizedCubicMultiplication, se mantiene como
+ * referencia para compararla con transpose.
+ *
+ * Parámetros:
+ * - matrix2d& matrix, matriz cuadrada que transponer
+ */
+void inPlaceTranspose(matrix2d& matrix) {
+	int rowCount = matrix.size();
+	int columnCount = matrix[0].size();
+	for (int row = 0; row < rowCount; row++) {
+		for (int column = row + 1; column < columnCount; column++) {
+			int tmp = matrix[row][column];
+			matrix[row][column] = matrix[column][row];
+			matrix[column][row] = tmp;
+		}
+	}
+}
+
+// Tamaño de los casos base de los algoritmos recursivos. Solo amortiza el
+// costo de la recursión, no depende del tamaño del caché
+constexpr int recursiveBaseSize = 16;
+
+/*
+ * Nombre: splitPoint
+ *
+ * Descripción: Calcula dónde dividir un rango en los algoritmos
+ * recursivos, cerca de la mitad pero redondeado a un múltiplo de
+ * recursiveBaseSize desde begin, así todos los bloques menos el último
+ * llegan completos al caso base, sin importar si el tamaño es potencia
+ * de 2
+ *
+ * Parámetros:
+ * - int begin, inicio del rango
+ * - int count, largo del rango, mayor a recursiveBaseSize
+ *
+ * Returns: int, posición donde comienza la segunda mitad
+ */
+int splitPoint(int begin, int count) {
+	return begin + (count / 2 + recursiveBaseSize - 1) / recursiveBaseSize * recursiveBaseSize;
+}
+
+/*
+ * Nombre: recursiveTranspose
+ *
+ * Descripción: escribe en out la transpuesta del bloque de in entre las
+ * filas rowBegin y rowEnd, y las columnas columnBegin y columnEnd. Divide
+ * en splitPoint la dimensión más grande del bloque hasta llegar al caso
+ * base, así en algún nivel de la recursión los bloques de entrada y
+ * salida caben en caché, sin importar su tamaño (cache-oblivious).
+ *
+ * Parámetros:
+ * - matrix2d& in, matriz que transponer
+ * - matrix2d& out, matriz transpuesta
+ * - int rowBegin, primera fila del bloque
+ * - int rowEnd, límite superior de filas del bloque
+ * - int columnBegin, primera columna del bloque
+ * - int columnEnd, límite superior de columnas del bloque
+ */
+void recursiveTranspose(matrix2d& in, matrix2d& out, int rowBegin, int rowEnd, int columnBegin, int columnEnd) {
+	int rowCount = rowEnd - rowBegin;
+	int columnCount = columnEnd - columnBegin;
+
+	if (rowCount <= recursiveBaseSize && columnCount <= recursiveBaseSize) {
+		for (int column = columnBegin; column < columnEnd; column++) {
+			int* outRow = out[column].data();
+			for (int row = rowBegin; row < rowEnd; row++) {
+				outRow[row] = in[row][column];
+			}
+		}
+		return;
+	}
+
+	if (rowCount >= columnCount) {
+		int middle = splitPoint(rowBegin, rowCount);
+		recursiveTranspose(in, out, rowBegin, middle, columnBegin, columnEnd);
+		recursiveTranspose(in, out, middle, rowEnd, columnBegin, columnEnd);
+	} else {
+		int middle = splitPoint(columnBegin, columnCount);
+		recursiveTranspose(in, out, rowBegin, rowEnd, columnBegin, middle);
+		recursiveTranspose(in, out, rowBegin, rowEnd, middle, columnEnd);
+	}
+}
+
+/*
+ * Nombre: transpose
+ *
+ * Descripción: transpone una matriz de cualquier forma fuera del lugar
+ * ocupando recursiveTranspose
+ *
+ * Parámetros:
+ * - matrix2d& matrix, matriz que transponer, no se modifica
+ *
+ * Returns: matrix2d, matriz transpuesta
+ */
+matrix2d transpose(matrix2d& matrix) {
+	int rowCount = matrix.size();
+	int columnCount = rowCount > 0 ? matrix[0].size() : 0;
+	matrix2d transposed(columnCount, vector<int>(rowCount));
+	recursiveTranspose(matrix, transposed, 0, rowCount, 0, columnCount);
+	return transposed;
+}
+
 // Algoritmos de multiplicación
 /*
  * Nombre: cubicMultiplication
@@ -108,35 +295,27 @@ void cubicMultiplication(matrix2d& A, matrix2d& B, matrix2d& out) {
  *
  * Descripción: multiplica 2 matrices ocupando el algoritmo cúbico de
  * multiplicación de matrices, pero aprovechandose del uso del cache
- * transponiendo la segunda matriz. Implementación personal del pseudocódigo
- * descrito en https://en.wikipedia.org/wiki/Matrix_multiplication_algorithm#Iterative_algorithm.
+ * recorriendo una copia transpuesta de la segunda matriz. Implementación
+ * personal del pseudocódigo descrito en https://en.wikipedia.org/wiki/Matrix_multiplication_algorithm#Iterative_algorithm.
  *
  * Parámetros:
  * - matrix2d& A, primera matriz que multiplicar
- * - matrix2d& B, segunda matriz que multiplicar
+ * - matrix2d& B, segunda matriz que multiplicar, no se modifica
  * - matrix2d& out, matriz resultante de la multiplicación
  */
 void optimizedCubicMultiplication(matrix2d& A, matrix2d& B, matrix2d& out) {
 	// Transponer matriz para optimizar el uso de caché
-	int rowCount = B.size();
-	int columnCount = B[0].size();
-	for (int row = 0; row < rowCount; row++) {
-		for (int column = row + 1; column < columnCount; column++) {
-			int tmp = B[row][column];
-			B[row][column] = B[column][row];
-			B[column][row] = tmp;
-		}
-	}
+	matrix2d transposedB = transpose(B);
 
 	// Multiplicación de matrices
-	rowCount = A.size();
-	columnCount = B[0].size();
+	int rowCount = A.size();
+	int columnCount = B[0].size();
 	int dimension = A[0].size();
 	for (int row = 0; row < rowCount; row++) {
 		for (int column = 0; column < columnCount; column++) {
 			int sum = 0;
 			for (int index = 0; index < dimension; index++) {
-				sum += A[row][index] * B[column][index];
+				sum += A[row][index] * transposedB[column][index];
 			}
 
 			out[row][column] = sum;
@@ -144,6 +323,101 @@ void optimizedCubicMultiplication(matrix2d& A, matrix2d& B, matrix2d& out) {
 	}
 }
 
+/*
+ * Nombre: recursiveMultiplicationStep
+ *
+ * Descripción: suma a out el producto del bloque de A entre las filas
+ * rowBegin y rowEnd y las columnas indexBegin e indexEnd, con el bloque de
+ * B entre las filas indexBegin e indexEnd y las columnas columnBegin y
+ * columnEnd. Divide en splitPoint la dimensión más grande hasta llegar al
+ * caso base, al dividir la dimensión compartida ambas mitades se suman
+ * sobre el mismo bloque de out.
+ *
+ * Parámetros:
+ * - matrix2d& A, primera matriz que multiplicar
+ * - matrix2d& B, segunda matriz que multiplicar
+ * - matrix2d& out, matriz donde acumular el resultado
+ * - int rowBegin, primera fila de A y out
+ * - int rowEnd, límite superior de filas de A y out
+ * - int indexBegin, primera columna de A y fila de B
+ * - int indexEnd, límite superior de columnas de A y filas de B
+ * - int columnBegin, primera columna de B y out
+ * - int columnEnd, límite superior de columnas de B y out
+ */
+void recursiveMultiplicationStep(matrix2d& A, matrix2d& B, matrix2d& out, int rowBegin, int rowEnd, int indexBegin, int indexEnd, int columnBegin, int columnEnd) {
+	int rowCount = rowEnd - rowBegin;
+	int dimension = indexEnd - indexBegin;
+	int columnCount = columnEnd - columnBegin;
+
+	if (rowCount <= recursiveBaseSize && dimension <= recursiveBaseSize && columnCount <= recursiveBaseSize) {
+		// Acumular cada fila de out en un arreglo local recorriendo las filas
+		// de B de forma contigua. Los bloques completos ocupan un largo
+		// constante para que el compilador pueda vectorizar
+		int sum[recursiveBaseSize];
+		for (int row = rowBegin; row < rowEnd; row++) {
+			int* outRow = out[row].data() + columnBegin;
+			const int* rowA = A[row].data();
+			for (int column = 0; column < columnCount; column++) sum[column] = outRow[column];
+
+			for (int index = indexBegin; index < indexEnd; index++) {
+				int value = rowA[index];
+				const int* rowB = B[index].data() + columnBegin;
+				if (columnCount == recursiveBaseSize) {
+					for (int column = 0; column < recursiveBaseSize; column++) {
+						sum[column] += value * rowB[column];
+					}
+				} else {
+					for (int column = 0; column < columnCount; column++) {
+						sum[column] += value * rowB[column];
+					}
+				}
+			}
+
+			for (int column = 0; column < columnCount; column++) outRow[column] = sum[column];
+		}
+		return;
+	}
+
+	if (rowCount >= dimension && rowCount >= columnCount) {
+		int middle = splitPoint(rowBegin, rowCount);
+		recursiveMultiplicationStep(A, B, out, rowBegin, middle, indexBegin, indexEnd, columnBegin, columnEnd);
+		recursiveMultiplicationStep(A, B, out, middle, rowEnd, indexBegin, indexEnd, columnBegin, columnEnd);
+	} else if (columnCount >= dimension) {
+		int middle = splitPoint(columnBegin, columnCount);
+		recursiveMultiplicationStep(A, B, out, rowBegin, rowEnd, indexBegin, indexEnd, columnBegin, middle);
+		recursiveMultiplicationStep(A, B, out, rowBegin, rowEnd, indexBegin, indexEnd, middle, columnEnd);
+	} else {
+		int middle = splitPoint(indexBegin, dimension);
+		recursiveMultiplicationStep(A, B, out, rowBegin, rowEnd, indexBegin, middle, columnBegin, columnEnd);
+		recursiveMultiplicationStep(A, B, out, rowBegin, rowEnd, middle, indexEnd, columnBegin, columnEnd);
+	}
+}
+
+/*
+ * Nombre: recursiveMultiplication
+ *
+ * Descripción: multiplica 2 matrices de cualquier forma compatible
+ * ocupando el algoritmo recursivo cache-oblivious, que divide la dimensión
+ * más grande hasta que los bloques caben en caché sin depender del tamaño
+ * de este. Implementación personal del pseudocódigo descrito en
+ * https://en.wikipedia.org/wiki/Matrix_multiplication_algorithm#Non-square_matrices
+ *
+ * Parámetros:
+ * - matrix2d& A, primera matriz que multiplicar
+ * - matrix2d& B, segunda matriz que multiplicar
+ * - matrix2d& out, matriz resultante de la multiplicación
+ */
+void recursiveMultiplication(matrix2d& A, matrix2d& B, matrix2d& out) {
+	int rowCount = A.size();
+	int columnCount = B[0].size();
+	int dimension = A[0].size();
+
+	for (int row = 0; row < rowCount; row++)
+		fill(out[row].begin(), out[row].end(), 0);
+
+	recursiveMultiplicationStep(A, B, out, 0, rowCount, 0, dimension, 0, columnCount);
+}
+
 /*
  * Nombre: strassenMultiplication
  *
@@ -226,39 +500,227 @@ matrix2d strassenMultiplication(matrix2d A, matrix2d B) {
 	return C;
 }
 
-int main() {
-	// Elección de algoritmo a testear
-	int algorithmSelection;
-	cout << "1) CubicMultiplication" << endl;
-	cout << "2) OptimizedCubicMultiplication" << endl;
-	cout << "3) StrassenMultiplication" << endl;
-	cout << "Select algorithm to test: ";
-	cin >> algorithmSelection;
-	cout << endl;
+// Multiplicación por lotes
 
-	string multiplicationFunctionName;
-	void (*multiplicationFunction)(matrix2d&, matrix2d&, matrix2d&);
-	switch (algorithmSelection) {
-		case 1:
-			multiplicationFunctionName = "CubicMultiplication";
-			multiplicationFunction = cubicMultiplication;
-			break;
-		case 2:
-			multiplicationFunctionName = "OptimizedCubicMultiplication";
-			multiplicationFunction = optimizedCubicMultiplication;
-			break;
-		default:
-			multiplicationFunctionName = "StrassenMultiplication";
-			multiplicationFunction = [](matrix2d& matrixA, matrix2d& matrixB, matrix2d& outMatrix) {
-				matrixB = strassenMultiplication(matrixA, matrixB);
-			};
-			break;
+/*
+ * Nombre: createMatrixBatch
+ *
+ * Descripción: Crea un lote de matrices cuadradas compuestas de solo 0
+ *
+ * Parámetros:
+ * - int dimension, cantidad de columnas y filas de cada matriz
+ * - int batchSize, cantidad de matrices del lote
+ *
+ * Returns: matrixBatch, nuevo lote generado con 0
+ */
+matrixBatch createMatrixBatch(int dimension, int batchSize) {
+	matrixBatch batch;
+	batch.dimension = dimension;
+	batch.batchSize = batchSize;
+	batch.blockCount = (batchSize + batchLaneCount - 1) / batchLaneCount;
+	batch.data = vector<int>(batch.blockCount * dimension * dimension * batchLaneCount, 0);
+	return batch;
+}
+
+/*
+ * Nombre: setBatchMatrix
+ *
+ * Descripción: Copia una matriz dentro de un lote en la posición indicada
+ *
+ * Parámetros:
+ * - matrixBatch& batch, lote en el que guardar la matriz
+ * - int index, posición de la matriz dentro del lote
+ * - matrix2d& matrix, matriz que copiar
+ */
+void setBatchMatrix(matrixBatch& batch, int index, matrix2d& matrix) {
+	int N = batch.dimension;
+	for (int row = 0; row < N; row++)
+		for (int column = 0; column < N; column++)
+			batch.data[batchIndex(batch, index, row, column)] = matrix[row][column];
+}
+
+/*
+ * Nombre: getBatchMatrix
+ *
+ * Descripción: Extrae una matriz de un lote
+ *
+ * Parámetros:
+ * - matrixBatch& batch, lote del que extraer la matriz
+ * - int index, posición de la matriz dentro del lote
+ *
+ * Returns: matrix2d, copia de la matriz en la posición indicada
+ */
+matrix2d getBatchMatrix(matrixBatch& batch, int index) {
+	int N = batch.dimension;
+	matrix2d matrix = createMatrix(N);
+	for (int row = 0; row < N; row++)
+		for (int column = 0; column < N; column++)
+			matrix[row][column] = batch.data[batchIndex(batch, index, row, column)];
+	return matrix;
+}
+
+/*
+ * Nombre: fixedBatchedKernel
+ *
+ * Descripción: multiplica los bloques de batchLaneCount matrices entre
+ * firstBlock y lastBlock de dos lotes con dimensión N conocida en tiempo
+ * de compilación. Los ciclos sobre las columnas y el bloque se desenrollan
+ * completamente y el ciclo más interno recorre matrices contiguas del
+ * bloque, por lo que el compilador puede vectorizarlo.
+ *
+ * Parámetros:
+ * - const int* A, datos del primer lote
+ * - const int* B, datos del segundo lote
+ * - int* out, datos del lote resultante
+ * - int firstBlock, primer bloque a multiplicar
+ * - int lastBlock, límite superior de bloques a multiplicar
+ */
+template <int N>
+void fixedBatchedKernel(const int* A, const int* B, int* out, int firstBlock, int lastBlock) {
+	constexpr int blockSize = N * N * batchLaneCount;
+
+	for (int block = firstBlock; block < lastBlock; block++) {
+		const int* blockA = A + block * blockSize;
+		const int* blockB = B + block * blockSize;
+		int* blockOut = out + block * blockSize;
+
+		for (int row = 0; row < N; row++) {
+			// Acumular la fila completa del resultado para cada matriz del bloque
+			int sum[N][batchLaneCount] = {};
+
+			for (int index = 0; index < N; index++) {
+				const int* a = blockA + (row * N + index) * batchLaneCount;
+
+				#pragma GCC unroll 32
+				for (int column = 0; column < N; column++) {
+					const int* b = blockB + (index * N + column) * batchLaneCount;
+
+					#pragma GCC unroll 16
+					for (int l = 0; l < batchLaneCount; l++) {
+						sum[column][l] += a[l] * b[l];
+					}
+				}
+			}
+
+			for (int column = 0; column < N; column++) {
+				int* c = blockOut + (row * N + column) * batchLaneCount;
+				for (int l = 0; l < batchLaneCount; l++) {
+					c[l] = sum[column][l];
+				}
+			}
+		}
 	}
+}
 
-	// Testear algortimo seleccionado con dataset seleccionado
-	cout << "Testing " << multiplicationFunctionName << endl;
+/*
+ * Nombre: genericBatchedKernel
+ *
+ * Descripción: igual que fixedBatchedKernel, pero con la dimensión
+ * indicada en tiempo de ejecución para los tamaños sin kernel especializado.
+ *
+ * Parámetros:
+ * - const int* A, datos del primer lote
+ * - const int* B, datos del segundo lote
+ * - int* out, datos del lote resultante
+ * - int N, dimensión de las matrices
+ * - int firstBlock, primer bloque a multiplicar
+ * - int lastBlock, límite superior de bloques a multiplicar
+ */
+void genericBatchedKernel(const int* A, const int* B, int* out, int N, int firstBlock, int lastBlock) {
+	int blockSize = N * N * batchLaneCount;
+	vector<int> sum(N * batchLaneCount);
+
+	for (int block = firstBlock; block < lastBlock; block++) {
+		const int* blockA = A + block * blockSize;
+		const int* blockB = B + block * blockSize;
+		int* blockOut = out + block * blockSize;
+
+		for (int row = 0; row < N; row++) {
+			fill(sum.begin(), sum.end(), 0);
+
+			for (int index = 0; index < N; index++) {
+				const int* a = blockA + (row * N + index) * batchLaneCount;
+				for (int column = 0; column < N; column++) {
+					const int* b = blockB + (index * N + column) * batchLaneCount;
+					int* s = sum.data() + column * batchLaneCount;
+					for (int l = 0; l < batchLaneCount; l++) {
+						s[l] += a[l] * b[l];
+					}
+				}
+			}
+
+			for (int column = 0; column < N; column++) {
+				int* c = blockOut + (row * N + column) * batchLaneCount;
+				for (int l = 0; l < batchLaneCount; l++) {
+					c[l] = sum[column * batchLaneCount + l];
+				}
+			}
+		}
+	}
+}
+
+/*
+ * Nombre: batchedMultiplication
+ *
+ * Descripción: multiplica cada par de matrices de los lotes A y B,
+ * repartiendo los bloques del lote entre varios hilos. Ocupa un kernel
+ * especializado para las dimensiones 2, 4, 8, 16 y 32.
+ *
+ * Parámetros:
+ * - matrixBatch& A, lote con las primeras matrices que multiplicar
+ * - matrixBatch& B, lote con las segundas matrices que multiplicar
+ * - matrixBatch& out, lote resultante, debe tener la misma forma que A y B
+ * - int threadCount, cantidad de hilos a ocupar
+ */
+void batchedMultiplication(matrixBatch& A, matrixBatch& B, matrixBatch& out, int threadCount) {
+	int N = A.dimension;
+	const int* a = A.data.data();
+	const int* b = B.data.data();
+	int* c = out.data.data();
+
+	auto kernel = [=](int firstBlock, int lastBlock) {
+		switch (N) {
+			case 2: fixedBatchedKernel<2>(a, b, c, firstBlock, lastBlock); break;
+			case 4: fixedBatchedKernel<4>(a, b, c, firstBlock, lastBlock); break;
+			case 8: fixedBatchedKernel<8>(a, b, c, firstBlock, lastBlock); break;
+			case 16: fixedBatchedKernel<16>(a, b, c, firstBlock, lastBlock); break;
+			case 32: fixedBatchedKernel<32>(a, b, c, firstBlock, lastBlock); break;
+			default: genericBatchedKernel(a, b, c, N, firstBlock, lastBlock); break;
+		}
+	};
+
+	// Repartir los bloques de forma equitativa entre los hilos
+	int blockCount = A.blockCount;
+	threadCount = max(1, min(threadCount, blockCount));
+	vector<thread> threads;
+	for (int t = 0; t < threadCount; t++) {
+		int firstBlock = blockCount * t / threadCount;
+		int lastBlock = blockCount * (t + 1) / threadCount;
+		threads.emplace_back(kernel, firstBlock, lastBlock);
+	}
+
+	for (thread& worker : threads) worker.join();
+}
+
+/*
+ * Nombre: testBatchedMultiplication
+ *
+ * Descripción: Testea batchedMultiplication con las matrices del dataset
+ * de dimensión menor o igual a maxBatchedDimension. Los pares de cada
+ * dimensión se repiten hasta llenar un lote de aproximadamente 2^22
+ * elementos por matriz, y se imprime la cantidad de multiplicaciones por
+ * segundo.
+ *
+ * Parámetros:
+ * - string datasetFileName, nombre del archivo del dataset
+ */
+void testBatchedMultiplication(string datasetFileName) {
+	constexpr int batchElementCount = 1 << 22;
+	int threadCount = max(1u, thread::hardware_concurrency());
+
+	cout << "Testing BatchedMultiplication" << endl;
 	ifstream dataFile;
-	dataFile.open("matrix_dataset/matrix.txt");
+	dataFile.open(datasetFileName);
 
 	int dataSizeCount;
 	dataFile >> dataSizeCount;
@@ -268,42 +730,804 @@ int main() {
 
 	int dimension;
 	for (; dataSizeCount > 0; dataSizeCount--) {
-		// Extraer tamaño de los vectores a testear del dataset
+		// Las dimensiones del dataset van en orden creciente, así que se deja
+		// de leer el archivo al pasar la máxima dimensión con kernel
 		dataFile >> dimension;
-		vector<int> testDurations;
+		if (dimension > maxBatchedDimension) break;
 
-		for (int testIndex = testCount; testIndex > 0; testIndex -= 2) {
-			// Extraer vector de testeo del dataset
-			matrix2d matrixA = createMatrix(dimension);
+		// Extraer pares de matrices de la dimensión actual
+		vector<matrix2d> matrices;
+		for (int testIndex = 0; testIndex < testCount; testIndex++) {
+			matrix2d matrix = createMatrix(dimension);
 			for (int row = 0; row < dimension; row++) {
 				for (int column = 0; column < dimension; column++) {
-					dataFile >> matrixA[row][column];
+					dataFile >> matrix[row][column];
 				}
 			}
+			matrices.push_back(matrix);
+		}
 
-			matrix2d matrixB = createMatrix(dimension);
-			for (int row = 0; row < dimension; row++) {
-				for (int column = 0; column < dimension; column++) {
-					dataFile >> matrixB[row][column];
-				}
-			}
+		// Se necesita al menos un par de matrices para llenar los lotes
+		int pairCount = testCount / 2;
+		if (pairCount == 0) {
+			cout << "BatchedMultiplication | Data Size: " << dimension << " | Skipped, dataset has no matrix pairs" << endl;
+			continue;
+		}
+
+		// Llenar lotes repitiendo los pares del dataset
+		int batchSize = batchElementCount / (dimension * dimension);
+		matrixBatch batchA = createMatrixBatch(dimension, batchSize);
+		matrixBatch batchB = createMatrixBatch(dimension, batchSize);
+		matrixBatch outBatch = createMatrixBatch(dimension, batchSize);
+		for (int index = 0; index < batchSize; index++) {
+			setBatchMatrix(batchA, index, matrices[2 * (index % pairCount)]);
+			setBatchMatrix(batchB, index, matrices[2 * (index % pairCount) + 1]);
+		}
+
+		// Multiplicar lotes y calcular tiempo
+		auto start = chrono::high_resolution_clock::now();
+		batchedMultiplication(batchA, batchB, outBatch, threadCount);
+		auto stop = chrono::high_resolution_clock::now();
+		auto duration = chrono::duration_cast<chrono::microseconds>(stop - start);
 
+		// Comparar todas las matrices de una muestra de bloques del lote,
+		// incluyendo el último que puede tener relleno, contra cubicMultiplication
+		vector<matrix2d> expected;
+		for (int pair = 0; pair < pairCount; pair++) {
 			matrix2d outMatrix = createMatrix(dimension);
+			cubicMultiplication(matrices[2 * pair], matrices[2 * pair + 1], outMatrix);
+			expected.push_back(outMatrix);
+		}
 
-			// Multiplicar matrices y calcular tiempo
-			auto start = chrono::high_resolution_clock::now();
-			multiplicationFunction(matrixA, matrixB, outMatrix);
-			auto stop = chrono::high_resolution_clock::now();
-			auto duration = chrono::duration_cast<chrono::microseconds>(stop - start);
-			testDurations.push_back(duration.count());
+		int blockStep = max(1, batchA.blockCount / 64);
+		for (int block = 0; block < batchA.blockCount; block += blockStep) {
+			int sampledBlock = block + blockStep >= batchA.blockCount ? batchA.blockCount - 1 : block;
+			int lastIndex = min((sampledBlock + 1) * batchLaneCount, batchSize);
+			for (int index = sampledBlock * batchLaneCount; index < lastIndex; index++) {
+				if (getBatchMatrix(outBatch, index) != expected[index % pairCount]) {
+					cout << "BatchedMultiplication result differs from CubicMultiplication at matrix " << index << endl;
+				}
+			}
 		}
 
 		// Mostrar resultados
-		cout << multiplicationFunctionName << " | ";
+		double seconds = max<long long>(duration.count(), 1) / 1e6;
+		cout << "BatchedMultiplication | ";
 		cout << "Data Size: " << dimension << " | ";
-		cout << "Duration: " << accumulate(testDurations.begin(), testDurations.end(), 0) / testCount << " μs" << endl;
+		cout << "Batch Size: " << batchSize << " | ";
+		cout << "Threads: " << threadCount << " | ";
+		cout << "Duration: " << duration.count() << " μs | ";
+		cout << "Throughput: " << (long long)(batchSize / seconds) << " multiplications/s" << endl;
 	}
 
-	cout << "Finished testing " << multiplicationFunctionName << endl;
+	cout << "Finished testing BatchedMultiplication" << endl;
 	dataFile.close();
 }
+
+// Matrices dispersas
+
+/*
+ * Nombre: denseToCSR
+ *
+ * Descripción: Convierte una matriz densa a formato CSR, guardando solo
+ * los elementos distintos de 0
+ *
+ * Parámetros:
+ * - matrix2d& matrix, matriz densa que convertir
+ *
+ * Returns: csrMatrix, matriz convertida
+ */
+csrMatrix denseToCSR(matrix2d& matrix) {
+	csrMatrix sparse;
+	sparse.rowCount = matrix.size();
+	sparse.columnCount = sparse.rowCount > 0 ? matrix[0].size() : 0;
+	sparse.rowPointers.push_back(0);
+
+	for (int row = 0; row < sparse.rowCount; row++) {
+		for (int column = 0; column < sparse.columnCount; column++) {
+			if (matrix[row][column] == 0) continue;
+			sparse.columnIndices.push_back(column);
+			sparse.values.push_back(matrix[row][column]);
+		}
+		sparse.rowPointers.push_back(sparse.values.size());
+	}
+
+	return sparse;
+}
+
+/*
+ * Nombre: denseToCSC
+ *
+ * Descripción: Convierte una matriz densa a formato CSC, guardando solo
+ * los elementos distintos de 0
+ *
+ * Parámetros:
+ * - matrix2d& matrix, matriz densa que convertir
+ *
+ * Returns: cscMatrix, matriz convertida
+ */
+cscMatrix denseToCSC(matrix2d& matrix) {
+	cscMatrix sparse;
+	sparse.rowCount = matrix.size();
+	sparse.columnCount = sparse.rowCount > 0 ? matrix[0].size() : 0;
+	sparse.columnPointers.push_back(0);
+
+	for (int column = 0; column < sparse.columnCount; column++) {
+		for (int row = 0; row < sparse.rowCount; row++) {
+			if (matrix[row][column] == 0) continue;
+			sparse.rowIndices.push_back(row);
+			sparse.values.push_back(matrix[row][column]);
+		}
+		sparse.columnPointers.push_back(sparse.values.size());
+	}
+
+	return sparse;
+}
+
+/*
+ * Nombre: csrToCSC
+ *
+ * Descripción: Convierte una matriz CSR a formato CSC contando los
+ * elementos de cada columna y luego repartiéndolos, sin pasar por la
+ * matriz densa
+ *
+ * Parámetros:
+ * - csrMatrix& matrix, matriz CSR que convertir
+ *
+ * Returns: cscMatrix, matriz convertida
+ */
+cscMatrix csrToCSC(csrMatrix& matrix) {
+	int nonZeroCount = matrix.values.size();
+
+	cscMatrix sparse;
+	sparse.rowCount = matrix.rowCount;
+	sparse.columnCount = matrix.columnCount;
+	sparse.columnPointers = vector<int>(matrix.columnCount + 1, 0);
+	sparse.rowIndices = vector<int>(nonZeroCount);
+	sparse.values = vector<int>(nonZeroCount);
+
+	// Contar elementos por columna y acumularlos para obtener los punteros
+	for (int column : matrix.columnIndices) sparse.columnPointers[column + 1]++;
+	for (int column = 0; column < matrix.columnCount; column++)
+		sparse.columnPointers[column + 1] += sparse.columnPointers[column];
+
+	// Recorrer por filas deja cada columna ordenada por fila
+	vector<int> nextPosition(sparse.columnPointers.begin(), sparse.columnPointers.end() - 1);
+	for (int row = 0; row < matrix.rowCount; row++) {
+		for (int p = matrix.rowPointers[row]; p < matrix.rowPointers[row + 1]; p++) {
+			int position = nextPosition[matrix.columnIndices[p]]++;
+			sparse.rowIndices[position] = row;
+			sparse.values[position] = matrix.values[p];
+		}
+	}
+
+	return sparse;
+}
+
+/*
+ * Nombre: csrToDense
+ *
+ * Descripción: Convierte una matriz CSR a una matriz densa
+ *
+ * Parámetros:
+ * - csrMatrix& matrix, matriz CSR que convertir
+ *
+ * Returns: matrix2d, matriz convertida
+ */
+matrix2d csrToDense(csrMatrix& matrix) {
+	matrix2d dense(matrix.rowCount, vector<int>(matrix.columnCount, 0));
+	for (int row = 0; row < matrix.rowCount; row++)
+		for (int p = matrix.rowPointers[row]; p < matrix.rowPointers[row + 1]; p++)
+			dense[row][matrix.columnIndices[p]] = matrix.values[p];
+	return dense;
+}
+
+/*
+ * Nombre: sparseMultiplication
+ *
+ * Descripción: multiplica 2 matrices CSR ocupando el algoritmo de
+ * Gustavson. Cada fila del resultado es la combinación lineal de las filas
+ * de B indicadas por la fila de A, y se acumula en un arreglo denso del
+ * ancho de B junto a un marcador de las columnas ya visitadas, así el
+ * costo es proporcional a la cantidad de multiplicaciones no nulas y no a
+ * N³.
+ *
+ * Parámetros:
+ * - csrMatrix& A, primera matriz que multiplicar
+ * - csrMatrix& B, segunda matriz que multiplicar
+ *
+ * Returns: csrMatrix, matriz resultante de la multiplicación
+ */
+csrMatrix sparseMultiplication(csrMatrix& A, csrMatrix& B) {
+	csrMatrix C;
+	C.rowCount = A.rowCount;
+	C.columnCount = B.columnCount;
+	C.rowPointers.push_back(0);
+
+	vector<int> accumulator(B.columnCount, 0);
+	vector<int> marker(B.columnCount, -1);
+	vector<int> rowColumns;
+
+	for (int row = 0; row < A.rowCount; row++) {
+		rowColumns.clear();
+
+		for (int p = A.rowPointers[row]; p < A.rowPointers[row + 1]; p++) {
+			int index = A.columnIndices[p];
+			int value = A.values[p];
+
+			for (int q = B.rowPointers[index]; q < B.rowPointers[index + 1]; q++) {
+				int column = B.columnIndices[q];
+				if (marker[column] != row) {
+					marker[column] = row;
+					accumulator[column] = 0;
+					rowColumns.push_back(column);
+				}
+				accumulator[column] += value * B.values[q];
+			}
+		}
+
+		// Guardar la fila ordenada por columna
+		sort(rowColumns.begin(), rowColumns.end());
+		for (int column : rowColumns) {
+			C.columnIndices.push_back(column);
+			C.values.push_back(accumulator[column]);
+		}
+		C.rowPointers.push_back(C.values.size());
+	}
+
+	return C;
+}
+
+/*
+ * Nombre: workerPool
+ *
+ * Descripción: Grupo de hilos que se crean una sola vez y se reutilizan
+ * en cada llamada a runWorkerPool, así las funciones que se llaman muchas
+ * veces no pagan la creación de hilos en cada llamada. El hilo que llama a
+ * runWorkerPool también trabaja, como el hilo 0, por lo que se crean
+ * threadCount - 1 hilos. Cada llamada a runWorkerPool aumenta generation,
+ * que los hilos ocupan para saber que hay una nueva tarea.
+ */
+struct workerPool {
+	int threadCount;
+	vector<thread> workers;
+	mutex poolMutex;
+	condition_variable wake;
+	condition_variable done;
+	const function<void(int)>* currentTask;
+	int pendingWorkers;
+	long long generation;
+	bool stopping;
+};
+
+/*
+ * Nombre: workerPoolLoop
+ *
+ * Descripción: Ciclo de cada hilo de un workerPool, espera una nueva tarea,
+ * la ejecuta con su índice y avisa cuando el último hilo termina, hasta
+ * que se llama a stopWorkerPool
+ *
+ * Parámetros:
+ * - workerPool& pool, grupo de hilos al que pertenece el hilo
+ * - int index, índice del hilo, entre 1 y pool.threadCount - 1
+ */
+void workerPoolLoop(workerPool& pool, int index) {
+	long long seenGeneration = 0;
+	unique_lock<mutex> lock(pool.poolMutex);
+	while (true) {
+		pool.wake.wait(lock, [&]() { return pool.stopping || pool.generation != seenGeneration; });
+		if (pool.stopping) return;
+
+		seenGeneration = pool.generation;
+		const function<void(int)>* task = pool.currentTask;
+		lock.unlock();
+		(*task)(index);
+		lock.lock();
+
+		if (--pool.pendingWorkers == 0) pool.done.notify_one();
+	}
+}
+
+/*
+ * Nombre: createWorkerPool
+ *
+ * Descripción: Inicializa un workerPool y crea sus hilos
+ *
+ * Parámetros:
+ * - workerPool& pool, grupo de hilos a inicializar
+ * - int threadCount, cantidad de hilos que ejecutarán cada tarea, contando
+ *   el que llama a runWorkerPool
+ */
+void createWorkerPool(workerPool& pool, int threadCount) {
+	pool.threadCount = max(1, threadCount);
+	pool.currentTask = nullptr;
+	pool.pendingWorkers = 0;
+	pool.generation = 0;
+	pool.stopping = false;
+
+	for (int index = 1; index < pool.threadCount; index++) {
+		pool.workers.emplace_back(workerPoolLoop, ref(pool), index);
+	}
+}
+
+/*
+ * Nombre: runWorkerPool
+ *
+ * Descripción: Ejecuta una tarea en todos los hilos de un workerPool,
+ * entregándole a cada uno su índice entre 0 y pool.threadCount - 1, y
+ * espera a que todos terminen
+ *
+ * Parámetros:
+ * - workerPool& pool, grupo de hilos que ejecuta la tarea
+ * - const function<void(int)>& task, tarea a ejecutar
+ */
+void runWorkerPool(workerPool& pool, const function<void(int)>& task) {
+	{
+		lock_guard<mutex> lock(pool.poolMutex);
+		pool.currentTask = &task;
+		pool.pendingWorkers = pool.workers.size();
+		pool.generation++;
+	}
+	pool.wake.notify_all();
+
+	task(0);
+
+	unique_lock<mutex> lock(pool.poolMutex);
+	pool.done.wait(lock, [&]() { return pool.pendingWorkers == 0; });
+}
+
+/*
+ * Nombre: stopWorkerPool
+ *
+ * Descripción: Detiene los hilos de un workerPool y espera a que terminen
+ *
+ * Parámetros:
+ * - workerPool& pool, grupo de hilos a detener
+ */
+void stopWorkerPool(workerPool& pool) {
+	{
+		lock_guard<mutex> lock(pool.poolMutex);
+		pool.stopping = true;
+	}
+	pool.wake.notify_all();
+
+	for (thread& worker : pool.workers) worker.join();
+	pool.workers.clear();
+}
+
+// Cantidad de elementos no nulos bajo la cual sparseVectorMultiplication
+// ocupa un solo hilo, ya que repartir el trabajo cuesta más que hacerlo
+constexpr int parallelNonZeroThreshold = 1 << 15;
+
+/*
+ * Nombre: sparseVectorMultiplication
+ *
+ * Descripción: multiplica una matriz CSR por un vector repartiendo las
+ * filas entre los hilos de un workerPool. Los cortes se hacen según la
+ * cantidad de elementos no nulos y no de filas, para que matrices con
+ * filas muy desiguales no dejen todo el trabajo a un solo hilo. Con menos
+ * de parallelNonZeroThreshold elementos no nulos se ocupa solo el hilo
+ * que llama.
+ *
+ * Parámetros:
+ * - csrMatrix& A, matriz que multiplicar
+ * - vector<int>& x, vector que multiplicar, de largo A.columnCount
+ * - vector<int>& y, vector resultante, de largo A.rowCount
+ * - workerPool& pool, hilos entre los que repartir las filas
+ */
+void sparseVectorMultiplication(csrMatrix& A, vector<int>& x, vector<int>& y, workerPool& pool) {
+	const int* rowPointers = A.rowPointers.data();
+	const int* columnIndices = A.columnIndices.data();
+	const int* values = A.values.data();
+	const int* in = x.data();
+	int* out = y.data();
+
+	auto kernel = [=](int firstRow, int lastRow) {
+		for (int row = firstRow; row < lastRow; row++) {
+			int sum = 0;
+			for (int p = rowPointers[row]; p < rowPointers[row + 1]; p++) {
+				sum += values[p] * in[columnIndices[p]];
+			}
+			out[row] = sum;
+		}
+	};
+
+	long long nonZeroCount = A.values.size();
+	if (nonZeroCount < parallelNonZeroThreshold || pool.threadCount == 1) {
+		kernel(0, A.rowCount);
+		return;
+	}
+
+	// Buscar la fila donde comienza cada parte de los elementos no nulos
+	int threadCount = pool.threadCount;
+	vector<int> firstRows(threadCount + 1, A.rowCount);
+	for (int t = 0; t < threadCount; t++) {
+		int target = nonZeroCount * t / threadCount;
+		firstRows[t] = lower_bound(A.rowPointers.begin(), A.rowPointers.end() - 1, target) - A.rowPointers.begin();
+	}
+	firstRows[0] = 0;
+
+	runWorkerPool(pool, [&](int t) {
+		kernel(firstRows[t], firstRows[t + 1]);
+	});
+}
+
+/*
+ * Nombre: vectorMultiplication
+ *
+ * Descripción: multiplica una matriz densa por un vector, sirve de
+ * referencia para sparseVectorMultiplication
+ *
+ * Parámetros:
+ * - matrix2d& A, matriz que multiplicar
+ * - vector<int>& x, vector que multiplicar
+ * - vector<int>& y, vector resultante
+ */
+void vectorMultiplication(matrix2d& A, vector<int>& x, vector<int>& y) {
+	int rowCount = A.size();
+	int columnCount = x.size();
+	for (int row = 0; row < rowCount; row++) {
+		int sum = 0;
+		for (int column = 0; column < columnCount; column++) {
+			sum += A[row][column] * x[column];
+		}
+		y[row] = sum;
+	}
+}
+
+/*
+ * Nombre: testSparseMultiplication
+ *
+ * Descripción: Compara sparseMultiplication contra
+ * optimizedCubicMultiplication, y sparseVectorMultiplication contra
+ * vectorMultiplication, con las matrices del dataset disperso. Cada caso
+ * del dataset tiene una estructura, dimensión y densidad, seguido de
+ * testCount matrices escritas como cantidad de elementos y luego tríos
+ * fila, columna, valor.
+ *
+ * Parámetros:
+ * - string datasetFileName, nombre del archivo del dataset
+ */
+void testSparseMultiplication(string datasetFileName) {
+	constexpr int vectorRepetitions = 100;
+	workerPool pool;
+	createWorkerPool(pool, thread::hardware_concurrency());
+
+	cout << "Testing SparseMultiplication" << endl;
+	ifstream dataFile;
+	dataFile.open(datasetFileName);
+
+	int caseCount;
+	dataFile >> caseCount;
+
+	int testCount;
+	dataFile >> testCount;
+
+	for (; caseCount > 0; caseCount--) {
+		// Extraer estructura, dimensión y densidad del caso
+		string structure;
+		int dimension;
+		double density;
+		dataFile >> structure >> dimension >> density;
+
+		long long nonZeroCount = 0;
+		vector<int> denseDurations, sparseDurations;
+		vector<int> denseVectorDurations, sparseVectorDurations;
+
+		for (int testIndex = testCount; testIndex > 0; testIndex -= 2) {
+			// Extraer par de matrices de testeo del dataset
+			matrix2d matrices[2] = {createMatrix(dimension), createMatrix(dimension)};
+			for (matrix2d& matrix : matrices) {
+				int elementCount;
+				dataFile >> elementCount;
+				for (int i = 0; i < elementCount; i++) {
+					int row, column, value;
+					dataFile >> row >> column >> value;
+					matrix[row][column] = value;
+				}
+			}
+
+			csrMatrix sparseA = denseToCSR(matrices[0]);
+			csrMatrix sparseB = denseToCSR(matrices[1]);
+
+			// Revisar que ambas conversiones a CSC coincidan
+			cscMatrix convertedA = csrToCSC(sparseA);
+			cscMatrix expectedA = denseToCSC(matrices[0]);
+			if (convertedA.columnPointers != expectedA.columnPointers || convertedA.rowIndices != expectedA.rowIndices || convertedA.values != expectedA.values) {
+				cout << "csrToCSC result differs from denseToCSC" << endl;
+			}
+			nonZeroCount += sparseA.values.size() + sparseB.values.size();
+
+			// Multiplicar matrices y calcular tiempo
+			auto start = chrono::high_resolution_clock::now();
+			csrMatrix sparseOut = sparseMultiplication(sparseA, sparseB);
+			auto stop = chrono::high_resolution_clock::now();
+			sparseDurations.push_back(chrono::duration_cast<chrono::microseconds>(stop - start).count());
+
+			matrix2d outMatrix = createMatrix(dimension);
+			start = chrono::high_resolution_clock::now();
+			optimizedCubicMultiplication(matrices[0], matrices[1], outMatrix);
+			stop = chrono::high_resolution_clock::now();
+			denseDurations.push_back(chrono::duration_cast<chrono::microseconds>(stop - start).count());
+
+			if (csrToDense(sparseOut) != outMatrix) {
+				cout << "SparseMultiplication result differs from OptimizedCubicMultiplication" << endl;
+			}
+
+			// Multiplicar matriz por vector y calcular tiempo
+			vector<int> x(dimension), y(dimension), denseY(dimension);
+			generate(x.begin(), x.end(), [dimension]() { return rand() % dimension; });
+
+			start = chrono::high_resolution_clock::now();
+			for (int i = 0; i < vectorRepetitions; i++) sparseVectorMultiplication(sparseA, x, y, pool);
+			stop = chrono::high_resolution_clock::now();
+			sparseVectorDurations.push_back(chrono::duration_cast<chrono::nanoseconds>(stop - start).count() / vectorRepetitions);
+
+			start = chrono::high_resolution_clock::now();
+			for (int i = 0; i < vectorRepetitions; i++) vectorMultiplication(matrices[0], x, denseY);
+			stop = chrono::high_resolution_clock::now();
+			denseVectorDurations.push_back(chrono::duration_cast<chrono::nanoseconds>(stop - start).count() / vectorRepetitions);
+
+			if (y != denseY) {
+				cout << "SparseVectorMultiplication result differs from VectorMultiplication" << endl;
+			}
+		}
+
+		// Mostrar resultados
+		int pairCount = denseDurations.size();
+		cout << "SparseMultiplication | ";
+		cout << "Structure: " << structure << " | ";
+		cout << "Data Size: " << dimension << " | ";
+		cout << "Density: " << density * 100 << "% | ";
+		cout << "Non Zero: " << nonZeroCount / (2 * pairCount) << " | ";
+		cout << "Dense: " << accumulate(denseDurations.begin(), denseDurations.end(), 0) / pairCount << " μs | ";
+		cout << "Sparse: " << accumulate(sparseDurations.begin(), sparseDurations.end(), 0) / pairCount << " μs | ";
+		cout << "Dense MV: " << accumulate(denseVectorDurations.begin(), denseVectorDurations.end(), 0) / pairCount << " ns | ";
+		cout << "Sparse MV: " << accumulate(sparseVectorDurations.begin(), sparseVectorDurations.end(), 0) / pairCount << " ns" << endl;
+	}
+
+	stopWorkerPool(pool);
+
+	cout << "Finished testing SparseMultiplication" << endl;
+	dataFile.close();
+}
+
+/*
+ * Nombre: checkMultiplication
+ *
+ * Descripción: Revisa si out es el producto de A y B con el algoritmo de
+ * Freivalds, comparando A * (B * r) con out * r para vectores r al azar de
+ * 0 y 1, en O(N²) por vector. Si out es incorrecto cada vector lo detecta
+ * con probabilidad de al menos 1/2. Las cuentas se hacen con unsigned, es
+ * decir módulo 2^32, así son válidas aunque el producto se desborde.
+ * Descrito en https://en.wikipedia.org/wiki/Freivalds%27_algorithm
+ *
+ * Parámetros:
+ * - matrix2d& A, primera matriz multiplicada
+ * - matrix2d& B, segunda matriz multiplicada
+ * - matrix2d& out, matriz resultante que revisar
+ *
+ * Returns: bool, si out coincide con A * B en todos los vectores probados
+ */
+bool checkMultiplication(matrix2d& A, matrix2d& B, matrix2d& out) {
+	constexpr int checkCount = 10;
+	int rowCount = A.size();
+	int columnCount = B[0].size();
+	int dimension = A[0].size();
+
+	vector<unsigned int> r(columnCount), Br(dimension);
+	for (int check = 0; check < checkCount; check++) {
+		for (int column = 0; column < columnCount; column++) r[column] = rand() % 2;
+
+		for (int index = 0; index < dimension; index++) {
+			unsigned int sum = 0;
+			for (int column = 0; column < columnCount; column++) sum += (unsigned int)B[index][column] * r[column];
+			Br[index] = sum;
+		}
+
+		for (int row = 0; row < rowCount; row++) {
+			unsigned int expected = 0;
+			for (int index = 0; index < dimension; index++) expected += (unsigned int)A[row][index] * Br[index];
+
+			unsigned int actual = 0;
+			for (int column = 0; column < columnCount; column++) actual += (unsigned int)out[row][column] * r[column];
+
+			if (expected != actual) return false;
+		}
+	}
+
+	return true;
+}
+
+/*
+ * Nombre: testMultiplicationFunction
+ *
+ * Descripción: Testea una función de multiplicación con un dataset de
+ * matrices cuadradas, leyendo un par de matrices a la vez para que las
+ * matrices grandes no tengan que estar todas en memoria. Imprime un
+ * promedio de cuanto tarda en multiplicar por cada dimensión del dataset,
+ * y avisa si algún resultado no pasa checkMultiplication.
+ *
+ * Parámetros:
+ * - string datasetFileName, nombre del archivo del dataset
+ * - string multiplicationFunctionName, nombre de la función a ocupar
+ * - void (*multiplicationFunction)(matrix2d&, matrix2d&, matrix2d&),
+ *   puntero a función de multiplicación que recibe las dos matrices y la
+ *   matriz resultante
+ */
+void testMultiplicationFunction(string datasetFileName, string multiplicationFunctionName, void (*multiplicationFunction)(matrix2d&, matrix2d&, matrix2d&)) {
+	cout << "Testing " << multiplicationFunctionName << endl;
+	ifstream dataFile;
+	dataFile.open(datasetFileName);
+
+	int dataSizeCount;
+	dataFile >> dataSizeCount;
+
+	int testCount;
+	dataFile >> testCount;
+
+	int dimension;
+	for (; dataSizeCount > 0; dataSizeCount--) {
+		// Extraer tamaño de los vectores a testear del dataset
+		dataFile >> dimension;
+		vector<long long> testDurations;
+
+		for (int testIndex = testCount; testIndex > 0; testIndex -= 2) {
+			// Extraer vector de testeo del dataset
+			matrix2d matrixA = createMatrix(dimension);
+			for (int row = 0; row < dimension; row++) {
+				for (int column = 0; column < dimension; column++) {
+					dataFile >> matrixA[row][column];
+				}
+			}
+
+			matrix2d matrixB = createMatrix(dimension);
+			for (int row = 0; row < dimension; row++) {
+				for (int column = 0; column < dimension; column++) {
+					dataFile >> matrixB[row][column];
+				}
+			}
+
+			matrix2d outMatrix = createMatrix(dimension);
+
+			// Multiplicar matrices y calcular tiempo
+			auto start = chrono::high_resolution_clock::now();
+			multiplicationFunction(matrixA, matrixB, outMatrix);
+			auto stop = chrono::high_resolution_clock::now();
+			auto duration = chrono::duration_cast<chrono::microseconds>(stop - start);
+			testDurations.push_back(duration.count());
+
+			if (!checkMultiplication(matrixA, matrixB, outMatrix)) {
+				cout << multiplicationFunctionName << " result differs from A * B with Data Size: " << dimension << endl;
+			}
+		}
+
+		// Mostrar resultados, promediando por par de matrices multiplicado
+		cout << multiplicationFunctionName << " | ";
+		cout << "Data Size: " << dimension << " | ";
+		cout << "Duration: " << accumulate(testDurations.begin(), testDurations.end(), 0LL) / (long long)testDurations.size() << " μs" << endl;
+	}
+
+	cout << "Finished testing " << multiplicationFunctionName << endl;
+	dataFile.close();
+}
+
+/*
+ * Nombre: testTranspose
+ *
+ * Descripción: Compara inPlaceTranspose contra transpose con las matrices
+ * del dataset, imprimiendo un promedio de cuanto tarda cada una por cada
+ * dimensión
+ *
+ * Parámetros:
+ * - string datasetFileName, nombre del archivo del dataset
+ */
+void testTranspose(string datasetFileName) {
+	cout << "Testing Transpose" << endl;
+	ifstream dataFile;
+	dataFile.open(datasetFileName);
+
+	int dataSizeCount;
+	dataFile >> dataSizeCount;
+
+	int testCount;
+	dataFile >> testCount;
+
+	int dimension;
+	for (; dataSizeCount > 0; dataSizeCount--) {
+		dataFile >> dimension;
+		long long inPlaceDuration = 0;
+		long long recursiveDuration = 0;
+
+		for (int testIndex = testCount; testIndex > 0; testIndex--) {
+			matrix2d matrix = createMatrix(dimension);
+			for (int row = 0; row < dimension; row++) {
+				for (int column = 0; column < dimension; column++) {
+					dataFile >> matrix[row][column];
+				}
+			}
+
+			// Transponer y calcular tiempo
+			auto start = chrono::high_resolution_clock::now();
+			matrix2d transposed = transpose(matrix);
+			auto stop = chrono::high_resolution_clock::now();
+			recursiveDuration += chrono::duration_cast<chrono::microseconds>(stop - start).count();
+
+			start = chrono::high_resolution_clock::now();
+			inPlaceTranspose(matrix);
+			stop = chrono::high_resolution_clock::now();
+			inPlaceDuration += chrono::duration_cast<chrono::microseconds>(stop - start).count();
+
+			if (matrix != transposed) {
+				cout << "transpose result differs from inPlaceTranspose" << endl;
+			}
+		}
+
+		// Mostrar resultados
+		cout << "Transpose | ";
+		cout << "Data Size: " << dimension << " | ";
+		cout << "In Place: " << inPlaceDuration / testCount << " μs | ";
+		cout << "Recursive: " << recursiveDuration / testCount << " μs" << endl;
+	}
+
+	cout << "Finished testing Transpose" << endl;
+	dataFile.close();
+}
+
+int main() {
+	// Elección de algoritmo a testear
+	int algorithmSelection;
+	cout << "1) CubicMultiplication" << endl;
+	cout << "2) OptimizedCubicMultiplication" << endl;
+	cout << "3) StrassenMultiplication" << endl;
+	cout << "4) RecursiveMultiplication" << endl;
+	cout << "5) BatchedMultiplication" << endl;
+	cout << "6) SparseMultiplication" << endl;
+	cout << "7) Transpose" << endl;
+	cout << "8) OptimizedCubic vs Recursive with large matrices (up to 8192, needs matrix_large.txt)" << endl;
+	cout << "Select algorithm to test: ";
+	cin >> algorithmSelection;
+	cout << endl;
+
+	string multiplicationFunctionName;
+	void (*multiplicationFunction)(matrix2d&, matrix2d&, matrix2d&);
+	switch (algorithmSelection) {
+		case 1:
+			multiplicationFunctionName = "CubicMultiplication";
+			multiplicationFunction = cubicMultiplication;
+			break;
+		case 2:
+			multiplicationFunctionName = "OptimizedCubicMultiplication";
+			multiplicationFunction = optimizedCubicMultiplication;
+			break;
+		case 3:
+			multiplicationFunctionName = "StrassenMultiplication";
+			multiplicationFunction = [](matrix2d& matrixA, matrix2d& matrixB, matrix2d& outMatrix) {
+				outMatrix = strassenMultiplication(matrixA, matrixB);
+			};
+			break;
+		case 4:
+			multiplicationFunctionName = "RecursiveMultiplication";
+			multiplicationFunction = recursiveMultiplication;
+			break;
+		case 5:
+			testBatchedMultiplication("matrix_dataset/matrix.txt");
+			return 0;
+		case 6:
+			testSparseMultiplication("matrix_dataset/sparse_matrix.txt");
+			return 0;
+		case 7:
+			testTranspose("matrix_dataset/matrix.txt");
+			return 0;
+		case 8:
+			testMultiplicationFunction("matrix_dataset/matrix_large.txt", "OptimizedCubicMultiplication", optimizedCubicMultiplication);
+			testMultiplicationFunction("matrix_dataset/matrix_large.txt", "RecursiveMultiplication", recursiveMultiplication);
+			return 0;
+		default:
+			cout << "Invalid selection" << endl;
+			return 1;
+	}
+
+	// Testear algortimo seleccionado con dataset seleccionado
+	testMultiplicationFunction("matrix_dataset/matrix.txt", multiplicationFunctionName, multiplicationFunction);
+}
@@ -3,6 +3,7 @@
 #include <vector>
 #include <algorithm>
 #include <cmath>
+#include <string>
 
 using namespace std;
 using matrix2d = vector<vector<int>>;
@@ -11,36 +12,129 @@ using matrix2d = vector<vector<int>>;
  * Nombre: generateMatrix
  *
  * Descripción: Genera una matriz con las dimensiones especificadas que
- * contiene números al azar con un valor máximo de la multiplicación de
- * sus dimensiones.
+ * contiene números al azar menores a valueLimit.
  *
  * Parámetros:
  * - matrix2d& matrix, matriz que rellenar
  * - int rowCount, cantidad de filas
  * - int columnCount, cantidad de columnas
+ * - int valueLimit, límite superior de los valores
  */
-void generateMatrix(matrix2d& matrix, int rowCount, int columnCount) {
+void generateMatrix(matrix2d& matrix, int rowCount, int columnCount, int valueLimit) {
 	for (int i = 0; i < rowCount; i++) {
 		// Generar columna con valores aleatorios
 		vector<int> column(columnCount);
 		generate(column.begin(), column.end(), rand);
 		
-		// Limitar valores a las dimensiones de la matriz
+		// Limitar valores
 		for (int columnIndex = 0; columnIndex < columnCount; columnIndex++) {
-			column[columnIndex] = column[columnIndex] % (columnCount * rowCount);
+			column[columnIndex] = column[columnIndex] % valueLimit;
 		}
 
 		matrix.push_back(column);
 	}
 }
 
-int main() {
-	constexpr int minPower = 2;
-	constexpr int maxPower = 10;
-	constexpr int testCount = 10;
+/*
+ * Nombre: generateUniformSparseMatrix
+ *
+ * Descripción: Rellena una matriz de 0 dejando cada elemento distinto de 0
+ * con probabilidad density, en posiciones al azar.
+ *
+ * Parámetros:
+ * - matrix2d& matrix, matriz de 0 que rellenar
+ * - double density, proporción de elementos distintos de 0
+ */
+void generateUniformSparseMatrix(matrix2d& matrix, double density) {
+	int dimension = matrix.size();
+	for (int row = 0; row < dimension; row++) {
+		for (int column = 0; column < dimension; column++) {
+			if (rand() < density * RAND_MAX) {
+				matrix[row][column] = rand() % dimension + 1;
+			}
+		}
+	}
+}
+
+/*
+ * Nombre: generateBandedMatrix
+ *
+ * Descripción: Rellena una matriz de 0 dejando distintos de 0 todos los
+ * elementos de una banda alrededor de la diagonal, con el ancho necesario
+ * para acercarse a la densidad pedida.
+ *
+ * Parámetros:
+ * - matrix2d& matrix, matriz de 0 que rellenar
+ * - double density, proporción de elementos distintos de 0
+ */
+void generateBandedMatrix(matrix2d& matrix, double density) {
+	int dimension = matrix.size();
+	int halfWidth = max(0, int(round((density * dimension - 1) / 2)));
+	for (int row = 0; row < dimension; row++) {
+		int firstColumn = max(0, row - halfWidth);
+		int lastColumn = min(dimension - 1, row + halfWidth);
+		for (int column = firstColumn; column <= lastColumn; column++) {
+			matrix[row][column] = rand() % dimension + 1;
+		}
+	}
+}
+
+/*
+ * Nombre: generatePowerLawMatrix
+ *
+ * Descripción: Rellena una matriz de 0 con filas de largo desigual, a cada
+ * fila se le asigna un rango al azar r y recibe cerca de 1 / r del total de
+ * elementos (ley de Zipf), en columnas al azar. Las filas que superan la
+ * dimensión se recortan, por lo que la densidad real queda algo por debajo
+ * de la pedida.
+ *
+ * Parámetros:
+ * - matrix2d& matrix, matriz de 0 que rellenar
+ * - double density, proporción de elementos distintos de 0
+ */
+void generatePowerLawMatrix(matrix2d& matrix, double density) {
+	int dimension = matrix.size();
+
+	// Escalar para que la suma esperada de los largos sea density * N²
+	double harmonic = 0;
+	for (int rank = 1; rank <= dimension; rank++) harmonic += 1.0 / rank;
+	double scale = density * dimension * dimension / harmonic;
 
+	vector<int> columns(dimension);
+	for (int column = 0; column < dimension; column++) columns[column] = column;
+
+	for (int row = 0; row < dimension; row++) {
+		int rank = rand() % dimension + 1;
+		int length = min(dimension, int(round(scale / rank)));
+
+		// Elegir length columnas distintas mezclando solo el inicio del vector
+		for (int i = 0; i < length; i++) {
+			swap(columns[i], columns[i + rand() % (dimension - i)]);
+			matrix[row][columns[i]] = rand() % dimension + 1;
+		}
+	}
+}
+
+/*
+ * Nombre: datasetGenerator
+ *
+ * Descripción: Genera un archivo .txt con matrices cuadradas al azar. La
+ * primera linea es n dimensiones a testear, la segunda k matrices por
+ * dimensión, luego siguen n sectores con la dimensión en su primera linea
+ * y k lineas con las matrices. Cada matriz se escribe apenas se genera,
+ * así las dimensiones grandes no necesitan estar todas en memoria.
+ *
+ * Parámetros:
+ * - string name, nombre del dataset a generar
+ * - int minPower, potencia minima de 2 a generar
+ * - int maxPower, potencia máxima de 2 a generar
+ * - int testCount, cantidad de matrices por potencia a generar
+ * - int valueLimit, límite superior de los valores, con 0 se limitan a la
+ *   cantidad de elementos de cada matriz
+ */
+void datasetGenerator(string name, int minPower, int maxPower, int testCount, int valueLimit) {
 	ofstream datasetFile;
-	datasetFile.open("matrix.txt");
+	datasetFile.open(name + ".txt");
 
 	// Ingresar cantidad de potencias de 2 a testear y 
 	// cantidad de test por potencia
@@ -56,7 +150,7 @@ int main() {
 		// Generar testCount matrices de prueba
 		for (int i = 0; i < testCount; i++) {
 			matrix2d matrix;
-			generateMatrix(matrix, matrixDimension, matrixDimension);
+			generateMatrix(matrix, matrixDimension, matrixDimension, valueLimit > 0 ? valueLimit : matrixDimension * matrixDimension);
 			
 			for (int row = 0; row < matrixDimension; row++) {
 				for (int column = 0; column < matrixDimension; column++) {
@@ -66,7 +160,83 @@ int main() {
 			datasetFile << endl;
 		}
 	}
-	cout << "matrix.txt generated" << endl;
+	cout << name << ".txt generated" << endl;
+
+	datasetFile.close();
+}
+
+int main(int argc, char* argv[]) {
+	constexpr int minPower = 2;
+	constexpr int maxPower = 10;
+	constexpr int testCount = 10;
+
+	datasetGenerator("matrix", minPower, maxPower, testCount, 0);
+
+	// Generar dataset de matrices grandes, con un solo par por dimensión,
+	// solo si se pide con el argumento "large" ya que ocupa cerca de 0.5 GB.
+	// Los valores se limitan a 100 para que los productos no se desborden
+	// y los resultados se puedan revisar
+	constexpr int largeMinPower = 11;
+	constexpr int largeMaxPower = 13;
+	constexpr int largeTestCount = 2;
+	constexpr int largeValueLimit = 100;
+
+	if (argc > 1 && string(argv[1]) == "large") {
+		datasetGenerator("matrix_large", largeMinPower, largeMaxPower, largeTestCount, largeValueLimit);
+	} else {
+		cout << "Skipping matrix_large.txt, run with argument \"large\" to generate it" << endl;
+	}
+
+	// Generar dataset de matrices dispersas, con una dimensión fija y
+	// densidad variable por cada estructura
+	constexpr int sparseDimension = 512;
+	constexpr int sparseTestCount = 2;
+	vector<double> densities = {0.001, 0.005, 0.01, 0.05, 0.1, 0.25, 0.5};
+	vector<string> structureNames = {"uniform", "banded", "power_law"};
+	vector<void (*)(matrix2d&, double)> structureGenerators = {
+		generateUniformSparseMatrix,
+		generateBandedMatrix,
+		generatePowerLawMatrix
+	};
+
+	ofstream datasetFile;
+	datasetFile.open("sparse_matrix.txt");
+
+	// Ingresar cantidad de casos y cantidad de matrices por caso
+	datasetFile << structureNames.size() * densities.size() << endl;
+	datasetFile << sparseTestCount << endl;
+
+	int structureCount = structureNames.size();
+	for (int structure = 0; structure < structureCount; structure++) {
+		for (double density : densities) {
+			cout << "Generating " << structureNames[structure] << " sparse matrix with " << density * 100 << "% density test cases" << endl;
+			datasetFile << structureNames[structure] << " " << sparseDimension << " " << density << endl;
+
+			// Generar sparseTestCount matrices y guardar solo sus elementos
+			// distintos de 0 como tríos fila, columna, valor
+			for (int i = 0; i < sparseTestCount; i++) {
+				matrix2d matrix(sparseDimension, vector<int>(sparseDimension, 0));
+				structureGenerators[structure](matrix, density);
+
+				vector<int> triplets;
+				for (int row = 0; row < sparseDimension; row++) {
+					for (int column = 0; column < sparseDimension; column++) {
+						if (matrix[row][column] == 0) continue;
+						triplets.push_back(row);
+						triplets.push_back(column);
+						triplets.push_back(matrix[row][column]);
+					}
+				}
+
+				datasetFile << triplets.size() / 3 << " ";
+				for (int value : triplets) {
+					datasetFile << value << " ";
+				}
+				datasetFile << endl;
+			}
+		}
+	}
+	cout << "sparse_matrix.txt generated" << endl;
 
 	datasetFile.close();
 }
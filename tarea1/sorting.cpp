@@ -6,6 +6,11 @@
 #include <ctime>
 #include <fstream>
 #include <string>
+#include <cmath>
+
+#if defined(__AVX2__) || defined(__SSE2__)
+#include <immintrin.h>
+#endif
 
 using namespace std;
 
@@ -83,20 +88,21 @@ void mergeSort(vector<int>& dataVector, int bottom, int top) {
 }
 
 /*
- * Nombre: quickSort
+ * Nombre: partitionRange
  *
- * Descripción: Función para sortear un vector de enteros ocupando el 
- * algortimo quick sort. Modificación del código presentado en
- * https://www.geeksforgeeks.org/cpp-program-for-quicksort/
+ * Descripción: Particiona un rango de un vector de enteros ocupando el
+ * último elemento como pivote (esquema de Lomuto), dejando a su izquierda
+ * los elementos menores o iguales y a su derecha los mayores. Es la
+ * partición ocupada por quickSort y quickSelect.
  *
  * Parámetros:
- * - vector<int>& dataVector, referencia al vector de enteros a ordenar
+ * - vector<int>& vec, referencia al vector de enteros a particionar
  * - int bottom, indice limite inferior
- * - int top, indice limite superior
+ * - int top, indice limite superior, posición del pivote
+ *
+ * Returns: int, posición final del pivote
  */
-void quickSort(vector<int>& vec, int bottom, int top) {
-    if (bottom >= top) return;
-
+int partitionRange(vector<int>& vec, int bottom, int top) {
 	int pivot = vec[top];
 	int i = bottom - 1;
 
@@ -114,10 +120,324 @@ void quickSort(vector<int>& vec, int bottom, int top) {
 	vec[p] = vec[top];
 	vec[top] = tmp;
 
+	return p;
+}
+
+/*
+ * Nombre: quickSort
+ *
+ * Descripción: Función para sortear un vector de enteros ocupando el 
+ * algortimo quick sort. Modificación del código presentado en
+ * https://www.geeksforgeeks.org/cpp-program-for-quicksort/
+ *
+ * Parámetros:
+ * - vector<int>& dataVector, referencia al vector de enteros a ordenar
+ * - int bottom, indice limite inferior
+ * - int top, indice limite superior
+ */
+void quickSort(vector<int>& vec, int bottom, int top) {
+    if (bottom >= top) return;
+
+	int p = partitionRange(vec, bottom, top);
+
 	quickSort(vec, bottom, p - 1);
 	quickSort(vec, p + 1, top);
 }
 
+// Algoritmos de selección
+
+/*
+ * Nombre: quickSelect
+ *
+ * Descripción: Deja en la posición k el elemento que quedaría ahí al
+ * ordenar el rango, con los menores o iguales antes y los mayores o
+ * iguales después (introselect). Ocupa partitionRange con la mediana de 3
+ * como pivote, y si la recursión supera 2 log2(n) niveles termina el rango
+ * restante con partial_sort, que es basado en heap, para no caer en O(n²).
+ *
+ * Parámetros:
+ * - vector<int>& vec, referencia al vector de enteros
+ * - int bottom, indice limite inferior
+ * - int top, indice limite superior
+ * - int k, posición a seleccionar, entre bottom y top
+ */
+void quickSelect(vector<int>& vec, int bottom, int top, int k) {
+	int depthLimit = 2 * log2(top - bottom + 1);
+
+	while (bottom < top) {
+		if (depthLimit-- == 0) {
+			partial_sort(vec.begin() + bottom, vec.begin() + k + 1, vec.begin() + top + 1);
+			return;
+		}
+
+		// Dejar la mediana de bottom, middle y top como pivote en top
+		int middle = bottom + (top - bottom) / 2;
+		if (vec[middle] < vec[bottom]) swap(vec[middle], vec[bottom]);
+		if (vec[top] < vec[bottom]) swap(vec[top], vec[bottom]);
+		if (vec[middle] < vec[top]) swap(vec[middle], vec[top]);
+
+		int p = partitionRange(vec, bottom, top);
+		if (p == k) return;
+
+		if (k < p) {
+			top = p - 1;
+		} else {
+			bottom = p + 1;
+		}
+	}
+}
+
+/*
+ * Nombre: floydRivestSelect
+ *
+ * Descripción: Igual que quickSelect, pero ocupando el algoritmo de
+ * Floyd-Rivest, que en rangos grandes elige recursivamente los pivotes
+ * desde una muestra para que k quede en un rango pequeño tras una sola
+ * partición. Implementación personal del pseudocódigo descrito en
+ * https://en.wikipedia.org/wiki/Floyd%E2%80%93Rivest_algorithm
+ *
+ * Parámetros:
+ * - vector<int>& vec, referencia al vector de enteros
+ * - int left, indice limite inferior
+ * - int right, indice limite superior
+ * - int k, posición a seleccionar, entre left y right
+ */
+void floydRivestSelect(vector<int>& vec, int left, int right, int k) {
+	while (right > left) {
+		// Reducir el rango a una muestra alrededor de k
+		if (right - left > 600) {
+			double n = right - left + 1;
+			double i = k - left + 1;
+			double z = log(n);
+			double s = 0.5 * exp(2 * z / 3);
+			double sd = 0.5 * sqrt(z * s * (n - s) / n) * (i < n / 2 ? -1 : 1);
+			int newLeft = max(left, int(k - i * s / n + sd));
+			int newRight = min(right, int(k + (n - i) * s / n + sd));
+			floydRivestSelect(vec, newLeft, newRight, k);
+		}
+
+		// Particionar alrededor de vec[k]
+		int pivot = vec[k];
+		int i = left;
+		int j = right;
+		swap(vec[left], vec[k]);
+		if (vec[right] > pivot) swap(vec[right], vec[left]);
+
+		while (i < j) {
+			swap(vec[i], vec[j]);
+			i++;
+			j--;
+			while (vec[i] < pivot) i++;
+			while (vec[j] > pivot) j--;
+		}
+
+		if (vec[left] == pivot) {
+			swap(vec[left], vec[j]);
+		} else {
+			j++;
+			swap(vec[j], vec[right]);
+		}
+
+		if (j <= k) left = j + 1;
+		if (k <= j) right = j - 1;
+	}
+}
+
+/*
+ * Nombre: heapTopK
+ *
+ * Descripción: Obtiene los k menores elementos de un vector manteniendo
+ * un max-heap de tamaño k, en O(n log k)
+ *
+ * Parámetros:
+ * - vector<int>& dataVector, referencia al vector de enteros, no se modifica
+ * - int k, cantidad de elementos a obtener, entre 1 y el largo del vector
+ *
+ * Returns: vector<int>, los k menores elementos ordenados
+ */
+vector<int> heapTopK(vector<int>& dataVector, int k) {
+	vector<int> heap(dataVector.begin(), dataVector.begin() + k);
+	make_heap(heap.begin(), heap.end());
+
+	int length = dataVector.size();
+	for (int index = k; index < length; index++) {
+		if (dataVector[index] >= heap.front()) continue;
+
+		pop_heap(heap.begin(), heap.end());
+		heap.back() = dataVector[index];
+		push_heap(heap.begin(), heap.end());
+	}
+
+	sort_heap(heap.begin(), heap.end());
+	return heap;
+}
+
+/*
+ * Nombre: partitionTopK
+ *
+ * Descripción: Obtiene los k menores elementos de un vector dejándolos al
+ * inicio con quickSelect y luego ordenando solo ese prefijo, en O(n + k log k)
+ *
+ * Parámetros:
+ * - vector<int>& dataVector, referencia al vector de enteros, queda particionado
+ * - int k, cantidad de elementos a obtener, entre 1 y el largo del vector
+ *
+ * Returns: vector<int>, los k menores elementos ordenados
+ */
+vector<int> partitionTopK(vector<int>& dataVector, int k) {
+	quickSelect(dataVector, 0, dataVector.size() - 1, k - 1);
+	sort(dataVector.begin(), dataVector.begin() + k);
+	return vector<int>(dataVector.begin(), dataVector.begin() + k);
+}
+
+/*
+ * Nombre: topKStream
+ *
+ * Descripción: Estado de un top-k incremental, guarda en un max-heap los k
+ * menores elementos recibidos hasta el momento, así la entrada no necesita
+ * estar completa ni guardarse.
+ */
+struct topKStream {
+	int k;
+	vector<int> heap;
+};
+
+/*
+ * Nombre: pushTopKStream
+ *
+ * Descripción: Agrega un elemento a un top-k incremental, descartándolo si
+ * ya hay k elementos menores o iguales
+ *
+ * Parámetros:
+ * - topKStream& stream, top-k incremental
+ * - int value, elemento a agregar
+ */
+void pushTopKStream(topKStream& stream, int value) {
+	if (int(stream.heap.size()) < stream.k) {
+		stream.heap.push_back(value);
+		push_heap(stream.heap.begin(), stream.heap.end());
+		return;
+	}
+
+	if (value >= stream.heap.front()) return;
+
+	pop_heap(stream.heap.begin(), stream.heap.end());
+	stream.heap.back() = value;
+	push_heap(stream.heap.begin(), stream.heap.end());
+}
+
+/*
+ * Nombre: topKStreamResult
+ *
+ * Descripción: Obtiene los k menores elementos recibidos por un top-k
+ * incremental, sin modificarlo
+ *
+ * Parámetros:
+ * - topKStream& stream, top-k incremental
+ *
+ * Returns: vector<int>, los menores elementos recibidos ordenados
+ */
+vector<int> topKStreamResult(topKStream& stream) {
+	vector<int> result = stream.heap;
+	sort_heap(result.begin(), result.end());
+	return result;
+}
+
+/*
+ * Nombre: streamingTopK
+ *
+ * Descripción: Obtiene los k menores elementos de un vector entregándolos
+ * uno a uno a un topKStream
+ *
+ * Parámetros:
+ * - vector<int>& dataVector, referencia al vector de enteros, no se modifica
+ * - int k, cantidad de elementos a obtener, entre 1 y el largo del vector
+ *
+ * Returns: vector<int>, los k menores elementos ordenados
+ */
+vector<int> streamingTopK(vector<int>& dataVector, int k) {
+	topKStream stream = {k, {}};
+	for (int value : dataVector) {
+		pushTopKStream(stream, value);
+	}
+	return topKStreamResult(stream);
+}
+
+// Cantidad de elementos que revisa blockHasSmaller
+constexpr int filterBlockSize = 16;
+
+/*
+ * Nombre: blockHasSmaller
+ *
+ * Descripción: Revisa si alguno de los filterBlockSize elementos de un
+ * bloque es menor que un umbral, comparándolos con instrucciones SIMD
+ * (AVX2 o SSE2) cuando están disponibles
+ *
+ * Parámetros:
+ * - const int* block, inicio del bloque
+ * - int threshold, umbral con el que comparar
+ *
+ * Returns: bool, si existe un elemento menor que threshold
+ */
+bool blockHasSmaller(const int* block, int threshold) {
+#if defined(__AVX2__)
+	__m256i limit = _mm256_set1_epi32(threshold);
+	__m256i low = _mm256_cmpgt_epi32(limit, _mm256_loadu_si256((const __m256i*)block));
+	__m256i high = _mm256_cmpgt_epi32(limit, _mm256_loadu_si256((const __m256i*)(block + 8)));
+	return !_mm256_testz_si256(_mm256_or_si256(low, high), _mm256_or_si256(low, high));
+#elif defined(__SSE2__)
+	__m128i limit = _mm_set1_epi32(threshold);
+	__m128i mask = _mm_setzero_si128();
+	for (int i = 0; i < filterBlockSize; i += 4) {
+		mask = _mm_or_si128(mask, _mm_cmplt_epi32(_mm_loadu_si128((const __m128i*)(block + i)), limit));
+	}
+	return _mm_movemask_epi8(mask) != 0;
+#else
+	int minimum = block[0];
+	for (int i = 1; i < filterBlockSize; i++) minimum = min(minimum, block[i]);
+	return minimum < threshold;
+#endif
+}
+
+/*
+ * Nombre: filteredTopK
+ *
+ * Descripción: Igual que streamingTopK, pero una vez que el heap tiene k
+ * elementos descarta bloques completos que no tienen ningún elemento menor
+ * que el máximo del heap, revisándolos con blockHasSmaller. Cuando n es
+ * grande y k pequeño casi todos los bloques se descartan.
+ *
+ * Parámetros:
+ * - vector<int>& dataVector, referencia al vector de enteros, no se modifica
+ * - int k, cantidad de elementos a obtener, entre 1 y el largo del vector
+ *
+ * Returns: vector<int>, los k menores elementos ordenados
+ */
+vector<int> filteredTopK(vector<int>& dataVector, int k) {
+	topKStream stream = {k, {}};
+	int length = dataVector.size();
+	const int* data = dataVector.data();
+
+	int index = 0;
+	for (; index < length && int(stream.heap.size()) < k; index++) {
+		pushTopKStream(stream, data[index]);
+	}
+
+	for (; index + filterBlockSize <= length; index += filterBlockSize) {
+		if (!blockHasSmaller(data + index, stream.heap.front())) continue;
+
+		for (int i = index; i < index + filterBlockSize; i++) {
+			pushTopKStream(stream, data[i]);
+		}
+	}
+
+	for (; index < length; index++) {
+		pushTopKStream(stream, data[index]);
+	}
+
+	return topKStreamResult(stream);
+}
+
 /*
  * Nombre: testSortingFunction
  *
@@ -175,6 +495,128 @@ void testSortingFunction(string datasetName, string datasetFileName, string sort
 	dataFile.close();
 }
 
+/*
+ * Nombre: testSelectionFunctions
+ *
+ * Descripción: Compara los algoritmos de selección y top-k contra ordenar
+ * el vector completo con std::sort, en un cierto dataset con distintos
+ * tamaños. Para cada tamaño n se prueba k = 1, 10, 100, ... hasta n / 10,
+ * y k = n / 2, imprimiendo el promedio de cuanto tarda cada algoritmo y
+ * avisando si algún resultado no coincide con el vector ordenado.
+ *
+ * Parámetros:
+ * - string datasetName, nombre del dataset
+ * - string datasetFileName, nombre del archivo del dataset
+ */
+void testSelectionFunctions(string datasetName, string datasetFileName) {
+	vector<string> selectionFunctionNames = {"QuickSelect", "FloydRivestSelect", "std::nth_element (C++)"};
+	vector<void (*)(vector<int>&, int)> selectionFunctions = {
+		[](vector<int>& testVector, int k) {
+			quickSelect(testVector, 0, testVector.size() - 1, k - 1);
+		},
+		[](vector<int>& testVector, int k) {
+			floydRivestSelect(testVector, 0, testVector.size() - 1, k - 1);
+		},
+		[](vector<int>& testVector, int k) {
+			nth_element(testVector.begin(), testVector.begin() + k - 1, testVector.end());
+		}
+	};
+
+	vector<string> topKFunctionNames = {"HeapTopK", "PartitionTopK", "StreamingTopK", "FilteredTopK"};
+	vector<vector<int> (*)(vector<int>&, int)> topKFunctions = {heapTopK, partitionTopK, streamingTopK, filteredTopK};
+
+	int selectionCount = selectionFunctions.size();
+	int topKCount = topKFunctions.size();
+
+	cout << "Testing selection with " << datasetName << " dataset" << endl;
+	ifstream dataFile;
+	dataFile.open(datasetFileName);
+
+	int dataSizeCount;
+	dataFile >> dataSizeCount;
+
+	int testCount;
+	dataFile >> testCount;
+
+	int dataSize;
+	for (; dataSizeCount > 0; dataSizeCount--) {
+		// Extraer tamaño de los vectores a testear del dataset
+		dataFile >> dataSize;
+
+		vector<int> kValues;
+		for (int k = 1; k <= dataSize / 10; k *= 10) kValues.push_back(k);
+		kValues.push_back(dataSize / 2);
+
+		// Duraciones acumuladas por cada k, primero las de selección y luego las de top-k
+		int kCount = kValues.size();
+		int functionCount = selectionCount + topKCount;
+		vector<vector<long long>> testDurations(kCount, vector<long long>(functionCount, 0));
+		long long sortDuration = 0;
+
+		for (int testIndex = testCount; testIndex > 0; testIndex--) {
+			// Extraer vector de testeo del dataset
+			vector<int> testVector(dataSize);
+			for (int index = 0; index < dataSize; index++) {
+				dataFile >> testVector[index];
+			}
+
+			// Ordenar copia completa como referencia
+			vector<int> sortedVector = testVector;
+			auto start = chrono::high_resolution_clock::now();
+			sort(sortedVector.begin(), sortedVector.end());
+			auto stop = chrono::high_resolution_clock::now();
+			sortDuration += chrono::duration_cast<chrono::microseconds>(stop - start).count();
+
+			for (int kIndex = 0; kIndex < kCount; kIndex++) {
+				int k = kValues[kIndex];
+
+				for (int f = 0; f < selectionCount; f++) {
+					vector<int> selectionVector = testVector;
+					start = chrono::high_resolution_clock::now();
+					selectionFunctions[f](selectionVector, k);
+					stop = chrono::high_resolution_clock::now();
+					testDurations[kIndex][f] += chrono::duration_cast<chrono::microseconds>(stop - start).count();
+
+					if (selectionVector[k - 1] != sortedVector[k - 1]) {
+						cout << selectionFunctionNames[f] << " result differs from std::sort with k = " << k << endl;
+					}
+				}
+
+				for (int f = 0; f < topKCount; f++) {
+					vector<int> topKVector = testVector;
+					start = chrono::high_resolution_clock::now();
+					vector<int> result = topKFunctions[f](topKVector, k);
+					stop = chrono::high_resolution_clock::now();
+					testDurations[kIndex][selectionCount + f] += chrono::duration_cast<chrono::microseconds>(stop - start).count();
+
+					if (!equal(result.begin(), result.end(), sortedVector.begin()) || int(result.size()) != k) {
+						cout << topKFunctionNames[f] << " result differs from std::sort with k = " << k << endl;
+					}
+				}
+			}
+		}
+
+		// Mostrar resultados
+		cout << "std::sort (C++) | ";
+		cout << datasetName << " | ";
+		cout << "Data Size: " << dataSize << " | ";
+		cout << "Duration: " << sortDuration / testCount << " μs" << endl;
+
+		for (int kIndex = 0; kIndex < kCount; kIndex++) {
+			for (int f = 0; f < functionCount; f++) {
+				cout << (f < selectionCount ? selectionFunctionNames[f] : topKFunctionNames[f - selectionCount]) << " | ";
+				cout << datasetName << " | ";
+				cout << "Data Size: " << dataSize << " | ";
+				cout << "k: " << kValues[kIndex] << " | ";
+				cout << "Duration: " << testDurations[kIndex][f] / testCount << " μs" << endl;
+			}
+		}
+	}
+
+	cout << "Finished testing selection with " << datasetName << " dataset" << endl;
+	dataFile.close();
+}
+
 int main() {
 	// Elección de algoritmo a testear
 	int algorithmSelection;
@@ -182,10 +624,20 @@ int main() {
 	cout << "2) MergeSort" << endl;
 	cout << "3) QuickSort" << endl;
 	cout << "4) std::sort (C++)" << endl;
+	cout << "5) Selection and Top-K (all datasets)" << endl;
 	cout << "Select algorithm to test: ";
 	cin >> algorithmSelection;
 	cout << endl;
 
+	// Los algoritmos de selección se comparan con todos los datasets
+	if (algorithmSelection == 5) {
+		testSelectionFunctions("random", "sorting_dataset/random.txt");
+		testSelectionFunctions("partially sorted", "sorting_dataset/partially_sorted.txt");
+		testSelectionFunctions("sorted", "sorting_dataset/sorted.txt");
+		testSelectionFunctions("reverse sorted", "sorting_dataset/reverse_sorted.txt");
+		return 0;
+	}
+
 	string sortingFunctionName;
 	void (*sortingFunction)(vector<int>&);
 	switch (algorithmSelection) {